@@ -21,6 +21,13 @@ private:
     int test4();
     int test5();
     int test6();
+    int test7();
+    int test8();
+    int test9();
+    int test10();
+    int test11();
+    int test12();
+    int test13();
     const char* testName();
     void runTest( Status& status, testFunction test );
     Status runAllTests();
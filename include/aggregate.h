@@ -0,0 +1,81 @@
+// -*- C++ -*-
+#ifndef _AGGREGATE_H
+#define _AGGREGATE_H
+
+#include "minirel.h"
+#include "schema.h"
+
+enum aggErrCodes {
+    BAD_GROUP_ATTR,
+    BAD_AGGREGATE,
+    TOO_FEW_AGG_BUFFERS,
+    AGG_RECORD_TOO_SHORT,
+    AGG_SUM_OVERFLOW,
+};
+
+enum AggFunc { aggCount, aggSum, aggMin, aggMax };
+
+// One aggregate of a GROUP BY.  "attrNo" must name an integer or real
+// attribute, except for aggCount, which ignores it.
+struct Aggregate
+{
+    AggFunc func;
+    int attrNo;
+};
+
+// SELECT group, agg1, agg2, ... FROM inFile GROUP BY group, over a heap
+// file of records laid out as "schema" (as for Sort and the joins).  The
+// result is a new heap file entered as "outFile", one record per group, in
+// no particular order: the group attribute as it is in the input, then one
+// 4-byte attribute per aggregate, an integer for aggCount and for
+// aggregates of integer attributes and a real otherwise (resultSchema
+// gives the layout).  Sums are kept in 64 bits (long long or double) and
+// only narrowed on output: real sums are rounded to float, and an integer
+// sum or count outside the range of an int fails the aggregation with
+// AGG_SUM_OVERFLOW.  As with Sort, everything happens in the constructor.
+//
+// Groups are kept in an open-addressing (linear probing) hash table laid
+// out in frames taken from the pool with BufMgr::reserveFrames: an array
+// of (hash, entry) slots, then the fixed-size entries themselves, each the
+// group key followed by the running aggregates.
+//
+// The input is read with a ParallelScan of "numThreads" threads.  Each
+// worker aggregates into a table of its own in a slice of the reserved
+// frames, and the tables are merged at the end, so the workers share
+// nothing but the spill files.  (A group one worker had to spill is
+// finished from the spill files, whatever the other workers held of it.)
+//
+// When a table is full, records of groups it does not hold are not lost
+// but spilled: turned into partial aggregates and hash partitioned into
+// temporary heap files (entered in the database directory while they
+// exist).  Once the input is done and the table written out, each spill
+// file is aggregated in turn the same way, with a fresh table and a new
+// hash function for any further spilling.  Every round writes out at least
+// one group, so this always finishes.
+//
+// At most "amtOfBuf" frames are used: one per worker (or two, whichever is
+// more) for the pages being read and written, one per spill partition,
+// and the rest for the tables.  With too few for "numThreads" workers,
+// fewer are used.
+
+class HashAggregate
+{
+public:
+    HashAggregate( const char* inFile, const Schema& schema, int groupAttr,
+                   int numAggs, const Aggregate aggs[], const char* outFile,
+                   int amtOfBuf, int numThreads, Status& status );
+    ~HashAggregate() {}
+
+    static Schema resultSchema( const Schema& schema, int groupAttr,
+                                int numAggs, const Aggregate aggs[] );
+      // Integer results are 4 bytes; see AGG_SUM_OVERFLOW above.
+
+    int numGroups;
+    int numSpilled;             // Partial aggregates written to spill files,
+    int numRounds;              // and tables filled, counting the first.
+    int threadsUsed;            // Workers, after any cut to fit the budget.
+
+    static const int MAX_SPILL_PARTS = 8;
+};
+
+#endif // _AGGREGATE_H
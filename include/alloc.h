@@ -0,0 +1,125 @@
+// -*- C++ -*-
+#ifndef _ALLOC_H
+#define _ALLOC_H
+
+#include <stddef.h>
+#include <new>
+#include <mutex>
+
+// Two allocators for memory that would otherwise come from new and delete
+// one object at a time.
+//
+// An Arena hands out memory by bumping a pointer through large chunks, and
+// takes it all back at once, when it is reset or destroyed; there is no
+// freeing single objects.  It suits memory that lives as long as some
+// larger thing: the globals of a SystemDefs, the scratch arrays of an
+// operator.  An Arena is not safe to share between threads.
+//
+// A SlabAllocator hands out objects of one fixed size, carved from slabs
+// of many objects, and keeps freed objects for reuse; slabs are given back
+// when the allocator is destroyed, or by trim() once all their objects are
+// free.  Each thread keeps a small cache of free objects per allocator, so
+// alloc() and free() normally touch no lock, and only take the
+// allocator's lock to move objects between the cache and the shared free
+// list a batch at a time.  Only MAX_CACHED allocators alive at once have
+// thread caches; any more, and those made without them, take the lock
+// every time.  An object may be freed by a thread other than the one that
+// allocated it.
+
+class Arena
+{
+public:
+    Arena( size_t chunkSize = DEFAULT_CHUNK );
+    ~Arena();
+
+    void* alloc( size_t size, size_t align = 8 );
+      // "align" must be a power of two.  Requests bigger than the chunk
+      // size get a chunk of their own.
+
+    char* strdup( const char* s );
+
+    template <class T> T* alloc_array( size_t n )
+    {
+        T* a = (T*) alloc( n * sizeof(T), alignof(T) );
+        for ( size_t i = 0; i < n; ++i )
+            new (a + i) T();
+        return a;
+    }
+      // Value-initialized objects (zeroed, for plain types); their
+      // destructors are never run, so only for types that do not need them.
+
+    void reset();
+      // Takes back everything allocated, keeping one chunk for reuse.
+
+    size_t bytesAllocated() const       { return allocated; }
+
+    static const size_t DEFAULT_CHUNK = 16384;
+
+private:
+    struct chunk
+    {
+        chunk* next;
+        size_t size;                    // Including this header.
+    };
+
+    chunk* chunks;                      // Newest first.
+    char* cur;
+    char* end;
+    size_t chunkSize;
+    size_t allocated;
+
+    Arena( const Arena& );
+    Arena& operator=( const Arena& );
+};
+
+class SlabAllocator
+{
+public:
+    SlabAllocator( size_t objectSize, int objectsPerSlab = 64,
+                   bool threadCaches = true );
+      // Without thread caches every free object is on the shared list,
+      // so trim() finds every empty slab; for allocators whose users hold
+      // a lock of their own anyway.
+    ~SlabAllocator();
+
+    void* alloc();
+    void free( void* p );
+
+    size_t trim();
+      // Gives back the slabs none of whose objects are allocated or in a
+      // thread's cache, and returns the number of bytes given back.
+
+    int numSlabs() const                { return slabCount; }
+    int objectsPerSlab() const          { return perSlab; }
+    size_t slabBytes() const;           // The memory one slab takes.
+
+    static const int CACHE_SIZE = 32;   // Free objects a thread keeps.
+    static const int MAX_CACHED = 64;   // Live allocators with thread
+                                        // caches.
+
+private:
+    struct free_object
+    {
+        free_object* next;
+    };
+
+    size_t objectSize;
+    int perSlab;
+    int id;                             // Its thread caches, if < MAX_CACHED,
+    unsigned generation;                // while they have this generation.
+
+    std::mutex lock;                    // Guards the rest.
+    free_object* freeList;
+    void* slabs;                        // Linked through their first word.
+    int slabCount;
+
+    free_object* take( int howmany, int& got );
+    void give( free_object* first, free_object* last );
+
+    friend struct slab_thread_caches;
+
+    SlabAllocator( const SlabAllocator& );
+    SlabAllocator& operator=( const SlabAllocator& );
+};
+
+#endif // _ALLOC_H
@@ -0,0 +1,91 @@
+// -*- C++ -*-
+#ifndef _BUFTRACE_H
+#define _BUFTRACE_H
+
+#include <stdio.h>
+#include "minirel.h"
+
+// Traces of buffer manager calls, for replaying a workload against other
+// pool sizes and replacement policies (see bufreplay.C).  BufMgr writes
+// one with startTrace/stopTrace; a trace holds the calls that succeeded,
+// in the order they took the buffer manager's latch.
+//
+// The file starts with a header (see BufTraceHeader), followed by one
+// record per call:
+//
+//   1 byte     the call (BufTraceOp) in the low 4 bits, flags in the high 4
+//   varint     the page, less the previous record's page (zigzag encoded)
+//   varint     nanoseconds since the previous record
+//   varint     for btNewPage, btReserve and btRelease only: the page count
+//
+// Varints are little-endian base-128, so a record is usually 3 to 6
+// bytes.  For btReserve and btRelease, the "page" is the index of the
+// first frame in the pool.
+
+enum BufTraceOp { btPin, btUnpin, btNewPage, btFreePage, btReserve,
+                  btRelease, NUM_BUF_TRACE_OPS };
+
+enum BufTraceFlags
+{
+    btEmpty = 0x10,             // btPin of a page not to be read.
+    btDirty = 0x20,             // btUnpin flags.
+    btHate  = 0x40,
+};
+
+struct BufTraceRecord
+{
+    BufTraceOp op;
+    int flags;
+    PageId page;
+    int count;                  // Pages or frames, or 0.
+    unsigned long long time;    // Nanoseconds since the trace began.
+};
+
+struct BufTraceHeader
+{
+    char magic[8];              // "MBTRACE1"
+    unsigned pageSize;
+    unsigned dbPages;           // Of the database traced,
+    unsigned poolSize;          // and its pool.
+    unsigned reserved;
+};
+
+class BufTraceWriter
+{
+public:
+    BufTraceWriter() : file(0) {}
+    ~BufTraceWriter()           { if ( file ) close(); }
+
+    Status open( const char* path, unsigned dbPages, unsigned poolSize );
+    void record( BufTraceOp op, int flags, PageId page, int count = 0 );
+      // Never fails; a write error is reported by close().
+    Status close();
+
+    long numRecords;
+
+private:
+    FILE* file;
+    PageId lastPage;
+    unsigned long long start, lastTime;
+    bool failed;
+};
+
+class BufTraceReader
+{
+public:
+    BufTraceReader() : file(0) {}
+    ~BufTraceReader()           { close(); }
+
+    Status open( const char* path );
+    Status next( BufTraceRecord& rec );  // DONE at the end.
+    void close();
+
+    BufTraceHeader header;
+
+private:
+    FILE* file;
+    PageId lastPage;
+    unsigned long long lastTime;
+};
+
+#endif // _BUFTRACE_H
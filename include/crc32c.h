@@ -0,0 +1,22 @@
+// -*- C++ -*-
+#ifndef _CRC32C_H
+#define _CRC32C_H
+
+// CRC-32C (Castagnoli) checksums, as used to stamp database pages.
+//
+// On x86 processors with SSE4.2 the crc32 instruction is used; elsewhere a
+// table-driven software version gives the same results.  The choice is made
+// once, the first time a checksum is computed.
+
+unsigned crc32c( const void* buf, unsigned len, unsigned crc = 0 );
+  // Returns the CRC-32C of "len" bytes at "buf".  Pass a previous result as
+  // "crc" to continue a checksum over several buffers.
+
+unsigned crc32c_sw( const void* buf, unsigned len, unsigned crc = 0 );
+  // The portable software version, always available (mostly for testing and
+  // benchmarking against the hardware path).
+
+bool crc32c_hw_available();
+  // Returns true if crc32c() is using the SSE4.2 instruction.
+
+#endif // _CRC32C_H
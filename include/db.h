@@ -3,6 +3,11 @@
 
 #include <string.h>
 #include <stdlib.h>
+#include <sys/types.h>
+#include <vector>
+#include <map>
+#include <set>
+#include <mutex>
 #include "page.h"
 
 
@@ -21,10 +26,14 @@ class DB
 public:
     // Constructors
     // Create a database with the specified number of pages where the page
-    // size is the default page size.
-    DB( const char* name, unsigned num_pages, Status& status );
-
-    // Open the database with the given name.
+    // size is the default page size.  If "compressed" is true, pages are
+    // stored compressed (see below); either way they are read and written
+    // as whole pages.
+    DB( const char* name, unsigned num_pages, Status& status,
+        bool compressed = false );
+
+    // Open the database with the given name.  Compressed databases are
+    // recognized automatically.
     DB( const char* name, Status& status );
 
     // Destructor : closes the database
@@ -38,6 +47,7 @@ public:
     const char* db_name() const;
     int db_num_pages() const;
     int db_page_size() const;
+    bool db_compressed() const;
 
 
     // Allocate a set of pages where the run size is taken to be 1 by default.
@@ -66,6 +76,22 @@ public:
     // Write the contents of the specified page.
     Status write_page(PageId pageno, Page* pageptr);
 
+    // Read or write the "count" pages numbered from "first", from or to
+    // the buffers in "pages", which need not be adjacent.  The pages of a
+    // checksum group (see below) go in one vectored call, checked or
+    // stamped together.
+    Status read_pages(PageId first, int count, Page* pages[]);
+    Status write_pages(PageId first, int count, Page* pages[]);
+
+    // Check every page of the database against its stored checksum, reading
+    // the file directly with "num_threads" threads.  The numbers of the pages
+    // that fail are returned in "bad_pages".  Pages never written are skipped.
+    Status verify_pages(std::vector<PageId>& bad_pages, int num_threads = 1);
+
+    // Byte offset of the given page within the UNIX file of an uncompressed
+    // database.
+    static off_t page_offset(PageId pageno);
+
     // Print out the space map of the database.
     Status dump_space_map();
 
@@ -77,7 +103,10 @@ public:
         FILE_IO_ERROR,
         FILE_NOT_FOUND,
         FILE_NAME_TOO_LONG,
-	NEG_RUN_SIZE
+	NEG_RUN_SIZE,
+        CHECKSUM_MISMATCH,
+        BAD_COMPRESSED_PAGE,
+        BAD_DB_HEADER
    };
 
 private:
@@ -85,6 +114,39 @@ private:
     unsigned num_pages;
     char* name;
 
+      // In-memory copy of the checksum blocks, read one group at a time as
+      // pages in the group are first touched.
+    unsigned* checksums;
+    bool* group_loaded;
+    unsigned num_groups_cached;
+
+      // Guards the checksum cache, and the page map and free runs of a
+      // compressed database, in the page I/O calls, which large objects
+      // make alongside the buffer manager.  Not held over uncompressed
+      // page transfers.
+    std::mutex cache_lock;
+
+      // Where each page of a compressed database is, in SECTOR_SIZE units.
+    static const unsigned SECTOR_SIZE = 128;
+    static const unsigned MAX_EXTENT = MINIBASE_PAGESIZE / SECTOR_SIZE;
+
+    struct map_entry
+    {
+        unsigned sector;        // First sector of the stored image.
+        unsigned short length;  // Stored bytes; 0 if never written, and
+                                // MINIBASE_PAGESIZE if kept uncompressed.
+        unsigned short sectors; // Sectors reserved for the image.
+        unsigned crc;           // Checksum of the uncompressed page.
+    };
+
+    bool compressed;
+    map_entry* page_map;
+    unsigned data_end;          // First sector past the stored images.
+    std::map<unsigned,unsigned> free_runs;
+                                // Free runs of sectors, first -> length,
+    std::set< std::pair<unsigned,unsigned> > runs_by_length;
+                                // and the same runs as (length, first).
+
 
     struct file_entry
     {
@@ -124,8 +186,53 @@ private:
          holds the "space map," which is a bit map representing pages allocated
          in the database.
 
+         Every page is protected by a CRC-32C checksum, stamped when the page
+         is written and checked when it is read back.  The checksums are not
+         part of any page: the UNIX file holds one "checksum block" in front
+         of every group of PAGES_PER_GROUP pages, so that page IDs map to file
+         offsets like this:
+
+           [checksums 0-255][page 0]...[page 255][checksums 256-511][page 256]...
+
+         A page never written has the reserved checksum UNSTAMPED (see
+         db.C), which no page is stamped with; the checksum blocks are
+         filled with it when the database is created.  A page is written
+         before its checksum, so a crash between the two leaves a whole page
+         that fails its check, just as a torn one does, until it is written
+         again.
+
+         A compressed database is laid out differently.  After a one-page
+         header comes the "page map," with a map_entry for every page, and
+         then the compressed page images packed into SECTOR_SIZE sectors.  A
+         page whose image still fits is rewritten in place; otherwise it moves
+         to a free run of sectors, or to the end of the file.  Free runs are
+         merged with their neighbours as they are freed, and a run that ends
+         at the end of the file is given back to it.  They are not stored but
+         rebuilt from the page map, which is checked against the header and
+         the file, when the database is opened.
+
        */
 
+      // Read the header and page map of a compressed database.
+    Status open_compressed();
+
+      // Page I/O for compressed databases.
+    Status read_compressed( PageId pageno, Page* pageptr );
+    Status write_compressed( PageId pageno, Page* pageptr );
+
+      // Reserve or release a run of sectors of a compressed database.
+    unsigned allocate_sectors( unsigned count );
+    void release_sectors( unsigned first, unsigned count );
+
+      // The threads of verify_pages, and the check of one group of pages.
+    static void verify_worker( struct verify_context* ctx,
+                               std::vector<PageId>* bad );
+    bool verify_group( unsigned group, char* buf, std::vector<PageId>& bad );
+
+      // Get a pointer to the cached checksum of the given page, reading its
+      // checksum block from disk if necessary.  Call with cache_lock held.
+    Status checksum_slot( PageId pageno, unsigned*& slot );
+
 
       // Set runsize bits starting from start to value specified
     Status set_bits( PageId start, unsigned runsize, int bit );
@@ -0,0 +1,101 @@
+// -*- C++ -*-
+#ifndef _HEAPSTREAM_H
+#define _HEAPSTREAM_H
+
+#include "minirel.h"
+#include "hfpage.h"
+
+// Error numbers of the HEAPFILE subsystem; HFPage's own are posted under
+// HEAPPAGE.
+enum heapStreamErrCodes {
+    RECORD_TOO_LONG,
+    NO_ROOM_FOR_STUB,
+};
+
+// Sequential access to heap files, for operators that write a file of
+// records in one pass and read it back in another: sort runs, join
+// partitions, query results.  A heap file is a chain of HFPage pages linked
+// by their next-page pointers; entering its first page in the database
+// directory is up to the caller.
+//
+// Each writer and each reader keeps exactly one page pinned, so an
+// operator can count them against its buffer budget.  Pages are unpinned
+// as "hated," since neither side comes back to a page it has finished.
+
+class HeapWriter
+{
+public:
+    HeapWriter() : page(0) {}
+
+    Status open( int expectedPages = 1 );
+      // Starts a new file.  Pages are allocated in extents of contiguous
+      // pages, the first with BufMgr::newPage, sized by "expectedPages"
+      // but at most MAX_EXTENT long; the unused end of the last extent is
+      // given back by close().
+
+    Status append( const char* rec, int len );
+    Status close( PageId& firstPage, int& numPages );
+
+    Status abort();
+      // Gives up on a file that has been opened but not closed: unpins the
+      // current page and frees every page of the file.
+
+    static const int MIN_EXTENT = 8;
+    static const int MAX_EXTENT = 64;
+
+private:
+    PageId first, cur, extentEnd;       // Pages [cur, extentEnd) are ours.
+    HFPage* page;
+    int numPages, expected;
+
+    Status next_page();
+};
+
+class HeapReader
+{
+public:
+    HeapReader() : page(0) {}
+
+    Status open( PageId firstPage, bool freePages = false );
+      // If "freePages" is true, each page is freed once it has been read:
+      // the file is consumed.
+
+    Status next( char*& rec, int& len );
+      // Returns DONE after the last record.  "rec" points into the pinned
+      // page and is good until the next call.
+
+    Status close();
+      // Unpins the current page; only needed when stopping early.
+
+    Status discard();
+      // Stops early and frees the rest of the file, the current page on.
+
+private:
+    PageId cur;
+    HFPage* page;
+    int slotNo;                         // The next to look at.
+    bool freePages;
+};
+
+// Frees every page of a heap file.
+Status destroy_heap_file( PageId firstPage );
+
+// Enters a temporary heap file in the database directory under a name
+// made of "prefix" and its first page, which no other live file shares, so
+// operators running at once never collide.  An entry of that name left
+// behind by an earlier run that failed names a page that has since been
+// freed and reused, and is replaced.  The name is put in "name", which
+// must hold MAX_NAME bytes.
+Status enter_temp_file( const char* prefix, PageId firstPage, char* name );
+
+// Access to single records by RID, following forwarding stubs (see
+// hfpage.h).  update_heap_record keeps the record's RID: it rewrites the
+// record on its page when it can, and otherwise moves it to the next page
+// of the file, or to a new page linked in after its own, leaving a stub.
+// A moved record that later fits back on its page is put back.  Each
+// pins at most three pages at a time.
+Status get_heap_record( const RID& rid, char* rec, int& len );
+Status update_heap_record( const RID& rid, const char* rec, int len );
+Status delete_heap_record( const RID& rid );
+
+#endif // _HEAPSTREAM_H
@@ -2,16 +2,19 @@
 #ifndef _HFPAGE_H
 #define _HFPAGE_H
 
+#include <stddef.h>
 #include "minirel.h"
 #include "page.h"
 #include "new_error.h"
 
 enum heapPageErrCodes {
     INVALID_SLOTNO,
+    RECORD_FORWARDED,
 };
 
 const int INVALID_SLOT =  -1;
 const int EMPTY_SLOT   =  -1;
+const int FORWARD_SLOT =  -2;
 
 // Class definition for a minibase data page.   
 // The design assumes that records are kept compacted when
@@ -19,13 +22,22 @@ const int EMPTY_SLOT   =  -1;
 // array cannot be compacted.  Notice, this class does not keep
 // the records aligned, relying instead on upper levels to take
 // care of non-aligned attributes.
+//
+// A record updated past the room on its page can be moved to another
+// page without changing its RID: its slot becomes a forwarding stub,
+// holding the RID of its new place, and the moved record is stored after
+// the RID of its stub.  Scans skip the stubs and find moved records where
+// they are; a page only holds the two halves, moving the record is up to
+// the caller (see update_heap_record in heapstream.h).
 
 class HFPage {
 
   protected:
     struct slot_t {
         short   offset;  
-        short   length;    // equals EMPTY_SLOT if slot is not in use
+        short   length;    // equals EMPTY_SLOT if slot is not in use,
+                           // FORWARD_SLOT for a forwarding stub, and
+                           // movedLength(length) for a moved record
     };
 
     static const int DPFIXED =       sizeof(slot_t)
@@ -51,6 +63,27 @@ class HFPage {
 
     char      data[MAX_SPACE - DPFIXED]; 
 
+      // The slot array runs on past slot[0] into data[].  Index it through
+      // this pointer rather than the one-element array, or an optimizing
+      // compiler may assume every index but 0 is out of bounds.
+    slot_t*   slots()  { return (slot_t*) ((char*) this + offsetof(HFPage, slot)); }
+
+      // the number of bytes of data[] taken by a slot of this length
+    static int storedLength(int length)
+    {
+        return length >= 0 ? length
+             : length == EMPTY_SLOT ? 0
+             : length == FORWARD_SLOT ? (int) sizeof(RID)
+             : (int) sizeof(RID) + movedLength(length);
+    }
+
+      // the slot length of a moved record of "length" bytes, one below
+      // FORWARD_SLOT even when empty; and, given that, the record's length
+    static int movedLength(int length) { return FORWARD_SLOT - 1 - length; }
+
+    Status reserveRecord(int recLen, RID& rid);
+    void   resizeRecord(int slotNo, int newLen);
+
   public:
 	HFPage();
 	
@@ -71,23 +104,51 @@ class HFPage {
     // the page, returns RID of record 
     Status insertRecord(char *recPtr, int recLen, RID& rid);
 
-    // delete the record with the specified rid
+    // delete the record with the specified rid.  Deleting a forwarding
+    // stub leaves the moved record to the caller.
     Status deleteRecord(const RID& rid);
 
+      // replaces the record with RID rid, keeping its RID; returns DONE
+      // if the page has no room for the new version.  Given a forwarding
+      // stub, puts the record back in its place.
+    Status updateRecord(const RID& rid, char *recPtr, int recLen);
+
+      // replaces the record with RID rid by a forwarding stub to "to";
+      // returns DONE if the page has no room for the stub
+    Status forwardRecord(const RID& rid, const RID& to);
+
+      // inserts a record moved here from RID "home", which becomes its
+      // forwarding stub
+    Status insertMovedRecord(char *recPtr, int recLen, const RID& home,
+                             RID& rid);
+
+      // returns true, and the RID it points to, if rid is a forwarding stub
+    bool   isForwarded(const RID& rid, RID& to);
+
       // returns RID of first record on page
-      // returns DONE if page contains no records.  Otherwise, returns OK
+      // returns DONE if page contains no records.  Otherwise, returns OK.
+      // These two report a moved record by its forwarding stub, whose RID
+      // is the record's, and skip the copy moved here from another page.
     Status firstRecord(RID& firstRid);
 
       // returns RID of next record on the page 
       // returns DONE if no more records exist on the page
     Status nextRecord (RID curRid, RID& nextRid);
 
-      // copies out record with RID rid into recPtr
+      // copies out record with RID rid into recPtr.  This and
+      // returnRecord post RECORD_FORWARDED for a forwarding stub.
     Status getRecord(RID rid, char *recPtr, int& recLen);
 
       // returns a pointer to the record with RID rid
     Status returnRecord(RID rid, char*& recPtr, int& recLen);
 
+      // returns pointers to up to "max" records, starting at slot "slotNo",
+      // and advances slotNo past the last slot examined.  Returns the
+      // number of records found; 0 means there are no more.  Moved
+      // records are given the RIDs of their stubs.
+    int    returnRecords(int& slotNo, int max, RID rids[], char* recPtrs[],
+                         int recLens[]);
+
       // returns the amount of available space on the page
     int    available_space(void);
 
@@ -0,0 +1,86 @@
+// -*- C++ -*-
+#ifndef _JOIN_H
+#define _JOIN_H
+
+#include "minirel.h"
+#include "schema.h"
+
+enum joinErrCodes {
+    BAD_JOIN_ATTR,
+    BAD_JOIN_OPERATOR,
+    TOO_FEW_JOIN_BUFFERS,
+    JOIN_RECORD_TOO_SHORT,
+};
+
+// Join operators over heap files (chains of HFPage pages entered in the
+// database directory, as for Sort).  Each joins "outerFile" with
+// "innerFile" on one attribute of each, and writes every matching pair,
+// the outer record followed by the inner one, to a new heap file entered as
+// "outFile".  The join attributes must have the same type and length.  As
+// with Sort, the whole join runs in the constructor.
+//
+// Both operators use at most "amtOfBuf" frames of the buffer pool, and at
+// least four.  One frame holds the output page and one or two the pages
+// being read; the rest are taken out of the pool with
+// BufMgr::reserveFrames and hold the in-memory side of the join.
+//
+// In memory, records are kept together with a hash table that is
+// radix-clustered rather than chained: the (hash, record) entries are laid
+// out bucket by bucket in one array, so a probe reads one short contiguous
+// stretch of it instead of following pointers around.
+//
+// If a join fails, its output and any temporary files it has written are
+// freed, their directory entries removed, and no frame is left pinned.
+
+
+// Grace hash join, with a shortcut when the inner file fits in amtOfBuf - 2
+// frames: it is then loaded into the hash table and the outer file probed
+// against it in a single pass.
+//
+// Otherwise both files are hash partitioned into amtOfBuf - 2 temporary
+// heap files each, which are entered in the database directory while they
+// exist, and the partitions are joined pair by pair, partitioning again
+// with a different hash function if need be.  A pair that is still too big
+// after MAX_DEPTH rounds (a key shared by too many records) is joined by
+// nested loops instead.  The inner file should be the smaller one.
+
+class HashJoin
+{
+public:
+    HashJoin( const char* outerFile, const Schema& outerSchema, int outerAttr,
+              const char* innerFile, const Schema& innerSchema, int innerAttr,
+              const char* outFile, int amtOfBuf, Status& status );
+    ~HashJoin() {}
+
+    int numResults;
+    int numPartitioned;         // Pairs of files that had to be partitioned.
+    int maxDepth;               // Deepest level of partitioning reached.
+    int numBlocks;              // Blocks of any nested loops fallback.
+
+    static const int MAX_DEPTH = 3;
+};
+
+
+// Block nested loops join: the outer file is read a block of amtOfBuf - 3
+// frames at a time, and the inner file scanned once per block.  The join
+// condition is "outer attribute op inner attribute" for any comparison op;
+// for aopEQ the block is hashed, and otherwise the block's join attribute
+// is compared with each inner record using the SIMD comparisons of vecops.h
+// (integers and reals) or strncmp (strings).  The outer file should be the
+// smaller one.
+
+class BlockNestedLoopJoin
+{
+public:
+    BlockNestedLoopJoin( const char* outerFile, const Schema& outerSchema,
+                         int outerAttr, AttrOperator op,
+                         const char* innerFile, const Schema& innerSchema,
+                         int innerAttr, const char* outFile, int amtOfBuf,
+                         Status& status );
+    ~BlockNestedLoopJoin() {}
+
+    int numResults;
+    int numBlocks;              // Times the inner file was scanned.
+};
+
+#endif // _JOIN_H
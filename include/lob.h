@@ -0,0 +1,117 @@
+// -*- C++ -*-
+#ifndef _LOB_H
+#define _LOB_H
+
+#include "minirel.h"
+#include "page.h"
+
+enum lobErrCodes {
+    LOB_TOO_LARGE,
+    BAD_LOCATOR,
+    BAD_LOB_OFFSET,
+};
+
+// Large objects: values too long for a record, stored across runs of
+// contiguous pages and referred to by a locator small enough to keep in
+// the record instead.  A locator names the object's directory page, which
+// lists its runs; the data pages hold nothing but the object's bytes.
+//
+// Objects are written once, in one pass, with a LobWriter, read with a
+// LobReader, and freed with destroy_lob.  Reads and writes of runs of
+// data pages go straight between the caller's buffer and the database
+// with DB::read_pages and write_pages, whole pages in place and only a
+// partial first or last page through a page of the reader's or writer's
+// own, so a long transfer is a few vectored calls and evicts nothing from
+// the pool.  Reads of fewer than DIRECT_PAGES pages go through the pool
+// instead, where the pages are cached for the next small read.  The pool
+// never holds a dirty data page, since data pages are not written through
+// it, and any copy it has of one is dropped when the page is allocated or
+// freed, so the two paths always agree.
+//
+// The direct calls to the DB are not under the buffer manager's latch,
+// but the DB keeps its checksums under a lock of its own, so objects can
+// be read and written while other threads use the pool.  Like heap files,
+// though, they allocate and free pages with no lock: threads that open,
+// write, close or destroy objects at once must hold one of their own.
+
+struct LobLocator
+{
+    PageId dirPage;
+    unsigned length;            // In bytes.
+};
+
+class LobWriter
+{
+public:
+    LobWriter() : dir(0) {}
+
+    Status open( unsigned expectedBytes = 0 );
+      // Starts a new object.  The directory page comes from BufMgr::newPage
+      // and stays pinned until close().  Data pages come from
+      // DB::allocate_page in runs, the first long enough for
+      // "expectedBytes" (at least MIN_RUN pages), each later one twice the
+      // last, all at most MAX_RUN; a shorter run is taken if the database
+      // has none that long.  The unused end of the last run is given back
+      // by close().
+
+    Status write( const char* buf, unsigned len );
+    Status close( LobLocator& loc );
+
+    void abort();
+      // Gives up on an object that has been opened but not closed, as
+      // after a failed write(): frees its data pages and its directory
+      // page.  A close() that fails does this itself.  Errors on the way
+      // are dropped, so the one that caused it is what is reported.
+
+    static const int MIN_RUN = 8;
+    static const int MAX_RUN = 1024;
+    static const int BATCH = 64;        // Most pages per write_pages call.
+
+private:
+    struct lob_directory* dir;
+    PageId dirPage;
+    PageId cur, runEnd;                 // Pages [cur, runEnd) are free.
+    int nextRun;
+    unsigned length;
+    char tail[MINIBASE_PAGESIZE];       // The partly filled last page,
+    unsigned tailLen;                   // and the bytes in it.
+
+    Status next_run();
+    Status write_batch( PageId first, int count, Page* pages[] );
+};
+
+class LobReader
+{
+public:
+    LobReader() : pos(0) {}
+
+    Status open( const LobLocator& loc );
+      // Reads the directory page; nothing stays pinned.
+
+    Status read( char* buf, unsigned& len );
+      // Reads up to "len" bytes from the current position and sets "len"
+      // to the number read.  Returns DONE at the end of the object.
+
+    Status seek( unsigned offset );
+    unsigned tell() const       { return pos; }
+    unsigned length() const;
+
+    static const int DIRECT_PAGES = 8;
+
+private:
+    char dirCopy[MINIBASE_PAGESIZE];
+    char head[MINIBASE_PAGESIZE];       // Partial first and last pages
+    char tail[MINIBASE_PAGESIZE];       // of a read.
+    unsigned pos;
+
+    PageId page_of( unsigned index, int& runLeft );
+    Status read_pooled( unsigned first, int count, char* buf,
+                        unsigned skip, unsigned len );
+    Status read_direct( unsigned first, int count, char* buf,
+                        unsigned skip, unsigned len );
+};
+
+// Frees the object's data pages and directory page.
+Status destroy_lob( const LobLocator& loc );
+
+#endif // _LOB_H
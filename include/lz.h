@@ -0,0 +1,26 @@
+// -*- C++ -*-
+#ifndef _LZ_H
+#define _LZ_H
+
+// A small LZ77 codec in the style of LZ4, used to compress page images.
+//
+// The output is a series of sequences.  Each sequence is a token byte (high
+// nibble: literal count, low nibble: match length - 4), any extra literal
+// count bytes, the literals, a two-byte little-endian match offset, and any
+// extra match length bytes.  A nibble of 15 means more count bytes follow,
+// each added in until one is less than 255.  The last sequence has literals
+// only.  Like LZ4, it favours speed over ratio: there is one hash probe per
+// position and no entropy coding.
+
+const int LZ_MAX_INPUT = 65535;
+
+int lz_compress( const void* src, int src_len, void* dst, int dst_capacity );
+  // Compresses "src_len" (<= LZ_MAX_INPUT) bytes at "src" into "dst".
+  // Returns the compressed length, or 0 if it would exceed "dst_capacity".
+
+int lz_decompress( const void* src, int src_len, void* dst, int dst_len );
+  // Expands "src_len" compressed bytes into exactly "dst_len" bytes at "dst".
+  // Returns "dst_len", or -1 if the input is malformed or the wrong size.
+  // Never reads or writes outside the given buffers.
+
+#endif // _LZ_H
@@ -123,6 +123,20 @@ POSTING ERRORS:
      if ( status != OK )
          return MINIBASE_RESULTING_ERROR( BUFMGR, status, BUFFEREXCEEDED );
 
+  Posting an error is cheap: the node records the subsystem, the error
+  number, and the file and line, and nothing is looked up or formatted until
+  the errors are shown.  A caller that recovers (by retrying, say) should
+  clear the errors it has dealt with.
+
+
+THREADS:
+  Each thread has its own minibase_errors, so threads post errors without
+  locks and without seeing each other's.  A thread that runs work for
+  another (a worker of a ParallelScan, say) must pass its errors on before
+  it ends, or they are lost: it moves them into a global_errors object the
+  two share with take_errors(), and the other thread then moves them from
+  there into its own minibase_errors, where it chains its own error.
+
 
 HANDLING ERRORS:
   There are a number of ways to find out what has gone wrong in the system.
@@ -185,7 +199,8 @@ enum Status { OK,
 			  SORTEDPAGE, BTINDEXPAGE, BTLEAFPAGE,
 			  LINEARHASH, GRIDFILE, RTREE, JOINS, PLANNER, PARSER,
 			  OPTIMIZER, FRONTEND, CATALOG, DBMGR, RAWFILE, LOCKMGR,
-			  XACTMGR, HEAPFILE, HEAPPAGE, SCAN,
+			  XACTMGR, HEAPFILE, HEAPPAGE, SCAN, PAXPAGE, SELECTION, SORT,
+			  AGGREGATE, LARGEOBJ,
 
 
                 // Other, legitimate, codes.
@@ -230,14 +245,18 @@ private:
 
   /* Every error that is logged by a call to global_error::add_error creates an
      error node.  The Status types are converted into strings in team_name().
-     A node contains either a from (type Status) variable or a message (char*). */
+     A node contains either a from (type Status) variable or a message (char*).
+     Nodes come from a slab allocator, and keep only pointers to the file name
+     and message (which must outlive the error, as literals do), so posting an
+     error neither formats anything nor, once warmed up, touches the heap. */
 
 class error_node
 {
 public:
     error_node( Status subsys, Status prior = OK, int err_index = -1,
+                const char* file = 0, int line = 0,
                 const char* extra_msg = 0 );
-    ~error_node();
+    ~error_node() {}
     void set_next(error_node* nxt)      { next_node = nxt; }
 	
     void show_error( ostream& to=cerr ) const;
@@ -250,12 +269,19 @@ public:
     const char* get_message() const
         { return error_string_table::get_message(subsystem,error_index); }
     const char* get_extra_message() const { return msg; }
+    const char* get_file() const        { return file; }
+    int get_line() const                { return line; }
+
+    static void* operator new( size_t size );
+    static void operator delete( void* p );
 
 private:
     error_node* next_node;
     Status subsystem;           // The subsystem that added the error.
     Status prior_status;        // The status that prompted the error, or OK.
-    char* msg;                  // An extra error message.
+    const char* file;           // Where it was posted, or NULL,
+    int line;                   // and the line there.
+    const char* msg;            // An extra error message, or NULL.
     int error_index;            // Index into subsystem's error messages, or -1.
 };
 
@@ -268,7 +294,7 @@ public:
     ~global_errors();
 
     Status add_error( Status subsystem, const char* msg )
-        { return add_error( new error_node(subsystem,OK,-1,msg) ); }
+        { return add_error( new error_node(subsystem,OK,-1,0,0,msg) ); }
       /* Discouraged: use MINIBASE_FIRST_ERROR() instead (and use a table of
          messages instead of literal strings in-line). */
 
@@ -284,6 +310,11 @@ public:
       /* If you have dealt with the errors, you may call clear_errors() to
          throw away all traces of them. */
 
+    void take_errors( global_errors& from );
+      /* Moves the errors of "from" to the end of these, leaving "from"
+         empty.  Only the thread that owns each side may touch it; see
+         THREADS, above. */
+
     void show_errors( ostream& to );
     void show_errors();         // Displays to cerr (out of line for debugger)
       /* If you would like to display the current set of errors, call
@@ -324,8 +355,8 @@ private:
     error_node* last;
 };
 
- // This is the global object that holds errors.
-extern global_errors minibase_errors;
+ // This is the object that holds the errors of the calling thread.
+extern thread_local global_errors minibase_errors;
 
 #define MINIBASE_FIRST_ERROR( SUBSYS, INDEX ) \
         ( minibase_errors.add_error(SUBSYS,OK,__LINE__,__FILE__,INDEX) )
@@ -0,0 +1,77 @@
+// -*- C++ -*-
+#ifndef _PAGECACHE_H
+#define _PAGECACHE_H
+
+#include <unordered_map>
+
+#include "page.h"
+#include "alloc.h"
+
+// The buffer manager's optional second tier: clean pages evicted from the
+// pool, kept compressed (with lz_compress) in memory, so that a working
+// set a little bigger than the pool costs a decompression rather than a
+// disk read.  Pages that do not compress are kept as they are.
+//
+// The tier is exclusive: get() hands a page back to the pool and forgets
+// it, so a page is never both in a frame and here, and only clean pages
+// are put here, so the copy here always matches the disk.  It has its own
+// LRU order and a cap on the memory it holds, counted in whole slabs of
+// its allocators, one per size class.  When a page needs a new slab that
+// would go over the cap, the least recently put pages go first, and the
+// slabs they leave empty are given back, until it fits.
+//
+// Not safe for concurrent use; BufMgr calls it under its latch.
+
+class PageCache
+{
+public:
+    PageCache( unsigned capacity );
+    ~PageCache();
+
+    bool get( PageId pid, Page* page );
+      // Copies the page into "page" and drops it, if it is here.
+    void put( PageId pid, const Page* page );
+    void remove( PageId pid );
+
+    void setCapacity( unsigned capacity );
+      // Keeps the pages already here, as many of the newest as fit.
+
+    unsigned bytesUsed() const  { return used; }
+    unsigned capacity() const   { return cap; }
+
+    long hits, misses, puts, evictions;
+
+    static const int SIZE_STEP = 128;   // Compressed sizes round up to this.
+    static const int SLAB_ENTRIES = 8;  // Pages per slab.
+
+private:
+    struct entry
+    {
+        PageId pid;
+        int length;                     // Compressed, or MAX_SPACE if not.
+        int sizeClass;
+        entry* newer;
+        entry* older;
+        char data[1];                   // "length" bytes, really.
+    };
+
+    unsigned cap, used;                 // In slab bytes.
+    std::unordered_map<PageId, entry*> index;
+    entry* newest;
+    entry* oldest;
+
+    int numClasses;
+    SlabAllocator** classes;            // Entries with up to
+                                        // (class + 1) * SIZE_STEP of data,
+    int* numLive;                       // and how many of each there are.
+    char* scratch;                      // For compressing into.
+
+    void unlink( entry* e );
+    void drop( entry* e );
+    void evict_oldest();
+
+    PageCache( const PageCache& );
+    PageCache& operator=( const PageCache& );
+};
+
+#endif // _PAGECACHE_H
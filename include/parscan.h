@@ -0,0 +1,94 @@
+// -*- C++ -*-
+#ifndef _PARSCAN_H
+#define _PARSCAN_H
+
+#include <vector>
+
+#include "minirel.h"
+#include "schema.h"
+#include "selection.h"
+
+// What a ParallelScan does with the records it reads.  Each worker thread
+// gets its own consumer, made with clone(), so consume() needs no locking;
+// at the end the workers' consumers are merged into the one the scan was
+// given.
+
+class ScanConsumer
+{
+public:
+    virtual ~ScanConsumer() {}
+
+    virtual ScanConsumer* clone() const = 0;
+      // A new, empty consumer of the same kind.
+
+    virtual Status consume( const RecordBatch& batch ) = 0;
+      // Called for each batch of records read; only the selected ones
+      // (batch.sel[0 .. batch.numSelected)) are wanted.  The page is
+      // pinned for the length of the call.
+
+    virtual void merge( const ScanConsumer& other ) = 0;
+      // Adds in the results of another consumer made by clone().
+};
+
+// COUNT, SUM, MIN and MAX of one integer or real attribute.
+class ScanAggregate : public ScanConsumer
+{
+public:
+    ScanAggregate( const Schema& schema, int attrNo );
+
+    ScanConsumer* clone() const;
+    Status consume( const RecordBatch& batch );
+    void merge( const ScanConsumer& other );
+
+    long long count;
+    double sum, min, max;       // min and max are meaningless if count == 0.
+
+private:
+    AttrType type;
+    int offset;
+};
+
+// The RIDs of the selected records, in no particular order.
+class ScanCollect : public ScanConsumer
+{
+public:
+    ScanConsumer* clone() const     { return new ScanCollect; }
+    Status consume( const RecordBatch& batch );
+    void merge( const ScanConsumer& other );
+
+    std::vector<RID> rids;
+};
+
+// A morsel-driven parallel scan of a heap file (a chain of HFPage pages
+// entered in the database directory).  The file is cut into morsels of
+// "morselPages" consecutive pages.  "numThreads" workers share the buffer
+// pool; each takes the next morsel off the chain, pins its pages, runs the
+// optional "filter" and its consumer over them a batch at a time, and
+// comes back for more, so a worker that gets slow pages simply takes fewer
+// morsels.  The whole scan runs in the constructor, the calling thread
+// being one of the workers.
+//
+// The pages of a heap file can only be found by following the chain, so
+// morsels are handed out in chain order from one shared cursor rather
+// than stolen from per-worker queues.  Only the pinning of a morsel's
+// pages is serialized; the work on them is not.
+//
+// The scan keeps up to numThreads * morselPages pages pinned.  The
+// Selection must not be in use elsewhere during the scan.  Errors posted
+// by the workers end up in the calling thread's minibase_errors.
+
+class ParallelScan
+{
+public:
+    ParallelScan( const char* fileName, Selection* filter,
+                  ScanConsumer& consumer, int numThreads, Status& status,
+                  int morselPages = MORSEL_PAGES );
+    ~ParallelScan() {}
+
+    int numMorsels;
+    int numPages;
+
+    static const int MORSEL_PAGES = 4;
+};
+
+#endif // _PARSCAN_H
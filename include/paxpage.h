@@ -0,0 +1,120 @@
+#ifndef _PAXPAGE_H
+#define _PAXPAGE_H
+
+#include "minirel.h"
+#include "page.h"
+#include "new_error.h"
+#include "schema.h"
+
+enum paxPageErrCodes {
+    INVALID_RECNO,
+    INVALID_ATTRNO,
+    ATTR_TYPE_MISMATCH,
+    SCHEMA_TOO_BIG,
+};
+
+// Class definition for a PAX ("Partition Attributes Across") data page.
+//
+// Where an HFPage keeps whole records side by side, a PAXPage holds records
+// of one fixed Schema and splits them up by attribute: the page is divided
+// into one "minipage" per attribute, and minipage i holds attribute i of
+// every record on the page, as a plain array.  A scan that needs only a few
+// attributes touches only their minipages, and integer and real minipages
+// can be filtered and summed with the SIMD operations of vecops.h.
+//
+// A record's slot number is its index in every minipage.  A bitmap at the
+// start of data[] marks the slots in use; deleting a record only clears its
+// bit, so records never move and RIDs stay valid.  Minipages are four-byte
+// aligned, so numeric minipages may be used as int or float arrays.
+
+class PAXPage {
+
+  protected:
+    static const int PAXFIXED = 4 * sizeof(short)
+                              + 3 * sizeof(PageId)
+                              + MAXATTRS * (sizeof(char) + 2 * sizeof(short));
+
+      // Warning:
+      // These items must all pack tight, (no padding) for
+      // the current implementation to work properly.
+
+    short     slotCnt;     // number of slots used (live or deleted)
+    short     capacity;    // number of slots that fit on the page
+    short     numAttrs;    // attributes in the schema
+    short     type;        // an arbitrary value used by subclasses as needed
+
+    PageId    prevPage;    // backward pointer to data page
+    PageId    nextPage;    // forward pointer to data page
+    PageId    curPage;     // page number of this page
+
+    char      attrType[MAXATTRS];   // AttrType of each attribute
+    short     attrLen[MAXATTRS];    // length of each attribute
+    short     miniPage[MAXATTRS];   // offset in data[] of each minipage
+
+    char      data[MAX_SPACE - PAXFIXED];   // slot bitmap, then minipages
+
+    bool      inUse( int slotNo ) const
+        { return (data[slotNo / 8] >> (slotNo % 8)) & 1; }
+
+  public:
+    PAXPage();
+    ~PAXPage() {};
+
+      // initialize a new page for records of the given schema.  Fails if
+      // not even one record would fit.
+    Status init(PageId pageNo, const Schema& schema);
+    void dumpPage();            // dump contents of a page
+
+    PageId getNextPage();       // returns value of nextPage
+    PageId getPrevPage();       // returns value of prevPage
+
+    void setNextPage(PageId pageNo);    // sets value of nextPage to pageNo
+    void setPrevPage(PageId pageNo);    // sets value of prevPage to pageNo
+
+    PageId page_no() { return curPage;} // returns the page number
+
+      // inserts a record, in the row format of the page's schema, returning
+      // its RID.  Returns DONE if the page is full.
+    Status insertRecord(const char *recPtr, RID& rid);
+
+      // delete the record with the specified rid
+    Status deleteRecord(const RID& rid);
+
+      // returns RID of first record on page
+      // returns DONE if page contains no records.  Otherwise, returns OK
+    Status firstRecord(RID& firstRid);
+
+      // returns RID of next record on the page
+      // returns DONE if no more records exist on the page
+    Status nextRecord (RID curRid, RID& nextRid);
+
+      // reassembles the record with RID rid, in row format, into recPtr
+    Status getRecord(RID rid, char *recPtr, int& recLen);
+
+      // Column access.  Minipage "attrNo" holds slotCount() values; the
+      // slot bitmap tells which of them belong to live records.
+    int slotCount()                         { return slotCnt; }
+    int recordCount();
+    const unsigned char* slotBitmap()       { return (unsigned char*) data; }
+    const char* column(int attrNo)          { return data + miniPage[attrNo]; }
+
+      // Sets a bit in "bits" (vec_bitmap_bytes(slotCount()) bytes) for
+      // each live record whose integer or real attribute satisfies "op".
+      // The operands are ints or floats to match the attribute.
+    Status selectColumn(int attrNo, AttrOperator op, const void* v1,
+                        const void* v2, unsigned char* bits);
+
+      // Sums an integer or real attribute over the records whose bits are
+      // set, or over all live records if "bits" is null.
+    Status sumColumn(int attrNo, const unsigned char* bits, long long& sum);
+    Status sumColumn(int attrNo, const unsigned char* bits, double& sum);
+
+      // Returns the number of records that can still be inserted.
+    int    available_slots(void);
+
+      // Returns true if the page has no records in it, false otherwise.
+    bool empty(void);
+
+};
+
+#endif // _PAXPAGE_H
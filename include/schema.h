@@ -0,0 +1,33 @@
+// -*- C++ -*-
+#ifndef _SCHEMA_H
+#define _SCHEMA_H
+
+#include "minirel.h"
+
+// The layout of a fixed-format record.  Attributes are packed one after
+// another with no padding, so (as with HFPage) numeric attributes may be
+// unaligned within a record; copy them out rather than casting in place.
+// Integers are ints and reals are floats.
+
+const int MAXATTRS = 16;
+
+struct AttrDesc
+{
+    AttrType attrType;
+    int attrLen;                // In bytes.
+    int attrOffset;             // From the start of the record.
+};
+
+class Schema
+{
+public:
+    Schema( int numAttrs, const AttrType types[], const int strLens[] = 0 );
+      // "strLens" gives the length of each attrString attribute; entries
+      // for other attributes are ignored.
+
+    int numAttrs;
+    int recLen;
+    AttrDesc attrs[MAXATTRS];
+};
+
+#endif // _SCHEMA_H
@@ -0,0 +1,104 @@
+// -*- C++ -*-
+#ifndef _SELECTION_H
+#define _SELECTION_H
+
+#include "minirel.h"
+#include "hfpage.h"
+#include "schema.h"
+
+enum selectionErrCodes {
+    BAD_PREDICATE,
+    RECORD_TOO_SHORT,
+};
+
+// One term of a selection: "attribute op value", or for aopRANGE
+// "value <= attribute <= value2".  The values point to an int or a float
+// to match an integer or real attribute, or to a null-terminated string
+// for a string attribute; strings compare as strncmp() over the attribute
+// length.  String values are not copied and must outlive the Selection.
+
+struct Predicate
+{
+    int attrNo;
+    AttrOperator op;
+    const void* value;
+    const void* value2;         // Upper bound for aopRANGE, else unused.
+};
+
+// The records of one batch, gathered from a pinned HFPage, and which of
+// them satisfied the selection.  "recs" point into the page, so they are
+// only good while the page stays pinned.
+
+const int SEL_BATCH = 256;
+
+struct RecordBatch
+{
+    int count;                          // Records in the batch.
+    RID rids[SEL_BATCH];
+    char* recs[SEL_BATCH];
+    int lens[SEL_BATCH];
+
+    int numSelected;                    // How many satisfied the selection,
+    unsigned short sel[SEL_BATCH];      // and their positions, ascending.
+
+    int nextSlot;                       // Where the next batch starts.
+};
+
+// A selection operator: evaluates a conjunction (lopAND) of predicates over
+// the records of heap pages with the fixed layout "schema".
+//
+// Rather than decoding and testing one record at a time, the operator
+// takes a batch of records off the page, gathers each predicate's
+// attribute into a plain array, and compares the array as a whole with
+// the SIMD comparisons of vecops.h, giving a bitmap per predicate.  The
+// bitmaps are ANDed together and turned into a selection vector.  Once
+// no record of the batch survives, the remaining predicates are skipped.
+//
+//     Selection select( schema, 2, preds, status );
+//     RecordBatch batch;
+//     for ( status = select.firstBatch(page, batch); status == OK;
+//           status = select.nextBatch(page, batch) )
+//         for ( int i = 0; i < batch.numSelected; ++i )
+//             ... batch.recs[batch.sel[i]] ...
+//
+// Like HFPage::firstRecord and nextRecord, firstBatch and nextBatch
+// return DONE when the page has no more records.  A batch may well have
+// no selected records.
+
+class Selection
+{
+public:
+    Selection( const Schema& schema, int numPreds, const Predicate preds[],
+               Status& status );
+      // Fails with BAD_PREDICATE if a predicate names no attribute of the
+      // schema, uses aopNOT, or has no value.  Predicates are evaluated in
+      // the order given, so put the most selective first.
+    ~Selection();
+
+    Status firstBatch( HFPage* page, RecordBatch& batch );
+    Status nextBatch( HFPage* page, RecordBatch& batch );
+
+    Status evaluate( RecordBatch& batch );
+      // Fills in the selection vector of a batch gathered by other means
+      // ("count", "recs" and "lens" must be set).  Fails with
+      // RECORD_TOO_SHORT if a record is shorter than the schema says.
+
+private:
+    struct term {
+        AttrOperator op;
+        AttrType type;
+        int offset, len;
+        int i1, i2;
+        float r1, r2;
+        const char *s1, *s2;
+    };
+
+    int numTerms;
+    term* terms;
+    int recLen;
+
+    void evaluate_term( const term& t, RecordBatch& batch,
+                        unsigned char* bits );
+};
+
+#endif // _SELECTION_H
@@ -0,0 +1,85 @@
+// -*- C++ -*-
+#ifndef _SORT_H
+#define _SORT_H
+
+#include <vector>
+
+#include "minirel.h"
+#include "schema.h"
+
+enum sortErrCodes {
+    BAD_SORT_ATTR,
+    TOO_FEW_BUFFERS,
+    SORT_RECORD_TOO_SHORT,
+};
+
+// External merge sort of a heap file: a chain of HFPage pages, linked by
+// their next-page pointers, whose first page is entered in the database
+// directory under the file's name.  The records have the fixed layout
+// "schema" and are sorted on attribute "sortAttr".  The output is a new
+// heap file, entered in the directory as "outFile"; the input file is left
+// alone.  The whole sort runs in the constructor.
+//
+// The sort uses at most "amtOfBuf" frames of the buffer pool.  During run
+// generation, amtOfBuf - 2 of them are taken out of the pool with
+// BufMgr::reserveFrames to hold records, one holds the input page and one
+// the output page.  A full workspace is sorted on fixed-width normalized
+// keys (the first 8 bytes of a string; the full key only breaks ties) and
+// written out as a run.  Runs are then merged amtOfBuf - 1 at a time with
+// a loser tree, in as many passes as it takes to get down to one.
+//
+// Runs and the output are written with HeapWriter, a stretch of contiguous
+// pages at a time, so they are written and read back sequentially, and run
+// pages are freed as soon as they have been merged.  If the sort fails, the
+// runs it has written are freed and no frame is left pinned.
+//
+// Ascending and Descending orders are stable.  Random order means no
+// order is needed: the records are copied in the order they are found.
+
+class Sort
+{
+public:
+    Sort( const char* inFile, const char* outFile, const Schema& schema,
+          int sortAttr, TupleOrder order, int amtOfBuf, Status& status );
+    ~Sort() {}
+
+    int numRuns;                // Runs written by run generation.
+    int numPasses;              // Merge passes made over them.
+
+private:
+    struct run
+    {
+        PageId first;
+        int numPages;
+    };
+
+    struct sort_entry
+    {
+        unsigned long long key;
+        unsigned offset;        // Of the record in the workspace.
+        unsigned len;
+    };
+
+    class entry_less;
+
+    Schema schema;
+    int keyOffset, keyLen;
+    AttrType keyType;
+    TupleOrder order;
+    int amtOfBuf;
+    char* workspace;
+    std::vector<run> runs;
+
+    unsigned long long normalize( const char* rec ) const;
+    int compare( unsigned long long key1, const char* rec1,
+                 unsigned long long key2, const char* rec2 ) const;
+      // Orders two records by their normalized keys, and if need be by
+      // their full keys.
+
+    Status generate_runs( PageId inFirst );
+    Status write_run( sort_entry* entries, int n );
+    Status merge( const run* in, int numIn, run& out );
+    void destroy_runs( const std::vector<run>& r, unsigned from = 0 );
+};
+
+#endif // _SORT_H
@@ -11,6 +11,7 @@
 //
 /////////////////////////////////////////////////////////////////
 
+#include "alloc.h"
 
 class BufMgr;
 class DB;
@@ -23,16 +24,19 @@ class SystemDefs
 
 public:
     SystemDefs( Status& status, const char* dbname, unsigned dbpages =0,
-                unsigned bufpoolsize =0, const char* replacement_policy =0 );
+                unsigned bufpoolsize =0, const char* replacement_policy =0,
+                bool compress_pages =false );
       /* This constructor uses a default log name and size, for multi-user
          Minibase.  For single-user Minibase, this is the designated
          constructor.  If "dbpages" is 0, the database is opened; if it is
-         greater than 0, the database is created with that number of pages. */
+         greater than 0, the database is created with that number of pages,
+         stored compressed if "compress_pages" is true. */
 
 
     SystemDefs( Status& status, const char* dbname, const char* logname,
                 unsigned dbpages, unsigned maxlogsize,
-                unsigned bufpoolsize =0, const char* replacement_policy =0 );
+                unsigned bufpoolsize =0, const char* replacement_policy =0,
+                bool compress_pages =false );
       /* This constructor lets you specify all aspects of the system. */
 
 
@@ -42,9 +46,12 @@ public:
     BufMgr*             GlobalBufMgr;
 
       /* We fake shared memory in single-user Minibase to simplify the
-         maintenance of the two versions. */
+         maintenance of the two versions.  It is an arena: what is allocated
+         from it (the buffer manager and its pool, the names) lives until
+         the SystemDefs is destroyed, and is never freed one at a time. */
+    Arena shmem;
     char* malloc( unsigned size )
-        { return new char[size]; }
+        { return (char*) shmem.alloc( size, 64 ); }
 
 #define  MINIBASE_SHMEM minibase_globals
 
@@ -61,7 +68,8 @@ public:
 protected:
     void init( Status& status, const char* dbname, const char* logname,
                unsigned dbpages, unsigned maxlogsize,
-               unsigned bufpoolsize, const char* replacement_policy );
+               unsigned bufpoolsize, const char* replacement_policy,
+               bool compress_pages );
 };
 
 extern SystemDefs* minibase_globals;
@@ -31,6 +31,13 @@ protected:
     virtual int test4();
     virtual int test5();
     virtual int test6();
+    virtual int test7();
+    virtual int test8();
+    virtual int test9();
+    virtual int test10();
+    virtual int test11();
+    virtual int test12();
+    virtual int test13();
 
       // ...and this method, which is printed as the kind of test being done,
       // for example "Disk Space Management".
@@ -0,0 +1,41 @@
+// -*- C++ -*-
+#ifndef _VECOPS_H
+#define _VECOPS_H
+
+#include "minirel.h"
+
+// Vectorized operations over arrays of attribute values, for scans that
+// filter and aggregate a column at a time.
+//
+// Results are bitmaps: bit i (byte i/8, bit i%8) stands for value i.  The
+// unused high bits of the last byte are always cleared.  The comparisons
+// use SSE2 where the compiler targets it, four values per instruction, and
+// plain loops otherwise.
+
+inline int vec_bitmap_bytes( int n )    { return (n + 7) / 8; }
+
+bool vec_select_int( const int* values, int n, AttrOperator op,
+                     int v1, int v2, unsigned char* bits );
+bool vec_select_real( const float* values, int n, AttrOperator op,
+                      float v1, float v2, unsigned char* bits );
+  /* Sets bit i of "bits" if values[i] satisfies "op" with v1 (and v2, the
+     upper bound, for aopRANGE, which includes both ends).  aopNOP selects
+     everything.  Returns false, leaving "bits" alone, if "op" is not a
+     comparison (aopNOT). */
+
+void vec_and( unsigned char* bits, const unsigned char* other, int n );
+  /* bits &= other, for "n" values. */
+
+int vec_count( const unsigned char* bits, int n );
+  /* Returns the number of bits set. */
+
+int vec_to_selection( const unsigned char* bits, int n, unsigned short* sel );
+  /* Writes the positions of the set bits, in ascending order, into "sel"
+     and returns how many there are: a "selection vector." */
+
+long long vec_sum_int( const int* values, int n, const unsigned char* bits );
+double vec_sum_real( const float* values, int n, const unsigned char* bits );
+  /* Returns the sum of the values whose bits are set, or of all of them if
+     "bits" is null. */
+
+#endif // _VECOPS_H
@@ -8,7 +8,10 @@
 
 #include "db.h"
 #include "page.h"
+#include "buftrace.h"
+#include "pagecache.h"
 #include<list>
+#include<mutex>
 
 #define NUMBUF 20   
 // Default number of frames, artifically small number for ease of debugging.
@@ -22,6 +25,9 @@
 
 #define HATED 2
 
+#define RESERVED 3
+// An empty frame lent out by reserveFrames.
+
 class Descriptor {
 public:
     PageId page_number = INVALID_PAGE;
@@ -39,7 +45,21 @@ enum bufErrCodes  {
     PAGENOTFOUNDERR,
     PINCOUNTERR,
     MEMERR,
-    FREEPINPAGEERR
+    FREEPINPAGEERR,
+    RESERVEERR,
+    TRACEERR,
+    BADTRACE
+};
+
+// What the pool has done since it was made or last reset.  A pin is a hit
+// if the page was already in the pool, and a tier hit if it came from the
+// second tier instead of a read; reads and writes are of pages on disk.
+struct BufStats {
+    long pins;
+    long hits;
+    long tierHits;
+    long reads;
+    long writes;
 };
 
 class Replacer;
@@ -50,6 +70,15 @@ private: // fill in this area
     Descriptor* bufDesc;
     int bufferSize;
     int globalTime = 0;
+    std::recursive_mutex latch;
+    // Held by every public method below, so that threads can share the
+    // pool; reads and writes of pages are done holding it.
+    BufStats stats;
+    BufTraceWriter* trace;  // While tracing.
+    PageCache* tier2;       // If there is a second tier.
+
+    Status readPage(PageId pageid, Page* page);
+    Status dropCopy(PageId pageid);
     
 public:
 
@@ -101,6 +130,40 @@ public:
     Status flushAllPages();
 	// Flush all pages of the buffer pool to disk, as per flushPage.
 
+    Status reserveFrames(int howmany, Page*& frames);
+        // Take "howmany" adjacent frames out of the pool, as working memory
+        // for an operator that needs a fixed budget (a sort, a join, ...).
+        // The frames' pages are flushed if dirty and dropped, and the pool
+        // does not use the frames again until they are given back with
+        // releaseFrames.  Fails if no run of unpinned frames is that long.
+
+    Status releaseFrames(Page* frames, int howmany);
+        // Give back frames taken with reserveFrames.
+
+    Status discardPage(PageId pageid, int howmany=1);
+        // Drop the page from the pool, if it is there, without writing it
+        // out; freePage does this before deallocating the page.  Fails if
+        // the page is pinned.  With "howmany", drops the run of pages
+        // starting there, in one pass over the pool.
+
+    Status startTrace(const char* path);
+    Status stopTrace();
+        // Record every successful pinPage, unpinPage, newPage, freePage,
+        // reserveFrames and releaseFrames to "path" (see buftrace.h) until
+        // stopTrace, or until the buffer manager is destroyed.
+
+    const BufStats& getStats() const { return stats; }
+    void resetStats();
+
+    Status setSecondTier(unsigned bytes);
+        // Keep loved pages evicted from the pool compressed in up to
+        // "bytes" of memory, and serve them from there when they are
+        // pinned again (see pagecache.h); 0 turns the tier off, and
+        // resizing it keeps the pages already there that fit.  Pages
+        // written to the DB other than through the pool while it is on
+        // leave stale copies in it.
+    const PageCache* secondTier() const { return tier2; }
+
     /* DO NOT REMOVE THIS METHOD */    
     Status unpinPage(PageId globalPageId_in_a_DB, int dirty=FALSE)
         //for backward compatibility with the libraries